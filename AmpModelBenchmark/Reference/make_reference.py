@@ -0,0 +1,137 @@
+"""
+Writes the fixed-weight reference models AmpModelBenchmark checks AmpModel against.
+
+With torch installed the outputs come from torch.nn.LSTM / torch.nn.GRU plus nn.Linear.
+Without it they come from the equations in the torch.nn.LSTM and torch.nn.GRU docs,
+in double precision, which is what torch computes for a single layer with batch size 1.
+
+    python make_reference.py > ../Source/ReferenceModels.h
+"""
+
+import math
+
+HIDDEN = 3
+NUM_SAMPLES = 16
+
+
+def weights(count, seed):
+    # small deterministic values that differ per gate, so a swapped gate changes the output
+    return [round(math.sin(seed * 12.9898 + i * 78.233) * 0.6, 4) for i in range(count)]
+
+
+def make_model(cell):
+    gates = (4 if cell == "lstm" else 3) * HIDDEN
+    return {
+        "type": cell,
+        "hidden_size": HIDDEN,
+        "skip": True,
+        "weight_ih": weights(gates, 1),
+        "weight_hh": weights(gates * HIDDEN, 2),
+        "bias_ih": weights(gates, 3),
+        "bias_hh": weights(gates, 4),
+        "dense_weight": weights(HIDDEN, 5),
+        "dense_bias": 0.05,
+    }
+
+
+def make_input():
+    return [round(0.8 * math.sin(i * 0.7) + 0.3 * math.cos(i * 2.3), 4) for i in range(NUM_SAMPLES)]
+
+
+def sigmoid(x):
+    return 1.0 / (1.0 + math.exp(-x))
+
+
+def run_equations(model, inputs):
+    h_size = model["hidden_size"]
+    w_ih, w_hh = model["weight_ih"], model["weight_hh"]
+    b_ih, b_hh = model["bias_ih"], model["bias_hh"]
+    h = [0.0] * h_size
+    c = [0.0] * h_size
+    out = []
+
+    for x in inputs:
+        rows = len(w_ih)
+        gi = [w_ih[r] * x + b_ih[r] for r in range(rows)]
+        gh = [sum(w_hh[r * h_size + k] * h[k] for k in range(h_size)) + b_hh[r] for r in range(rows)]
+
+        if model["type"] == "lstm":
+            # gate order i, f, g, o
+            g = [gi[r] + gh[r] for r in range(rows)]
+            i_ = [sigmoid(v) for v in g[0:h_size]]
+            f_ = [sigmoid(v) for v in g[h_size:2 * h_size]]
+            g_ = [math.tanh(v) for v in g[2 * h_size:3 * h_size]]
+            o_ = [sigmoid(v) for v in g[3 * h_size:4 * h_size]]
+            c = [f_[k] * c[k] + i_[k] * g_[k] for k in range(h_size)]
+            h = [o_[k] * math.tanh(c[k]) for k in range(h_size)]
+        else:
+            # gate order r, z, n, with b_hn inside r * (...)
+            r_ = [sigmoid(gi[k] + gh[k]) for k in range(h_size)]
+            z_ = [sigmoid(gi[h_size + k] + gh[h_size + k]) for k in range(h_size)]
+            n_ = [math.tanh(gi[2 * h_size + k] + r_[k] * gh[2 * h_size + k]) for k in range(h_size)]
+            h = [(1 - z_[k]) * n_[k] + z_[k] * h[k] for k in range(h_size)]
+
+        y = sum(model["dense_weight"][k] * h[k] for k in range(h_size)) + model["dense_bias"]
+        out.append(y + x if model["skip"] else y)
+
+    return out
+
+
+def run_torch(model, inputs):
+    import torch
+
+    h_size = model["hidden_size"]
+    rnn = (torch.nn.LSTM if model["type"] == "lstm" else torch.nn.GRU)(1, h_size).double()
+    dense = torch.nn.Linear(h_size, 1).double()
+    rows = len(model["weight_ih"])
+
+    with torch.no_grad():
+        rnn.weight_ih_l0.copy_(torch.tensor(model["weight_ih"], dtype=torch.float64).reshape(rows, 1))
+        rnn.weight_hh_l0.copy_(torch.tensor(model["weight_hh"], dtype=torch.float64).reshape(rows, h_size))
+        rnn.bias_ih_l0.copy_(torch.tensor(model["bias_ih"], dtype=torch.float64))
+        rnn.bias_hh_l0.copy_(torch.tensor(model["bias_hh"], dtype=torch.float64))
+        dense.weight.copy_(torch.tensor(model["dense_weight"], dtype=torch.float64).reshape(1, h_size))
+        dense.bias.fill_(model["dense_bias"])
+
+        x = torch.tensor(inputs, dtype=torch.float64).reshape(-1, 1, 1)
+        y = dense(rnn(x)[0]).reshape(-1) + x.reshape(-1)
+
+    return y.tolist()
+
+
+def run(model, inputs):
+    try:
+        return run_torch(model, inputs)
+    except ImportError:
+        return run_equations(model, inputs)
+
+
+def cpp_array(values):
+    return "{ " + ", ".join(repr(float(v)) + "f" for v in values) + " }"
+
+
+def main():
+    inputs = make_input()
+    print("//Generated by Reference/make_reference.py, don't edit by hand")
+    print("#pragma once\n")
+    print("namespace ReferenceModels\n{")
+    print(f"    constexpr int numSamples = {NUM_SAMPLES};")
+    print(f"    constexpr float input[numSamples] = {cpp_array(inputs)};\n")
+
+    for cell in ("lstm", "gru"):
+        model = make_model(cell)
+        print(f"    namespace {cell}")
+        print("    {")
+        print(f"        constexpr int hiddenSize = {model['hidden_size']};")
+        for key in ("weight_ih", "weight_hh", "bias_ih", "bias_hh", "dense_weight"):
+            name = "".join(part.capitalize() if i else part for i, part in enumerate(key.split("_")))
+            print(f"        constexpr float {name}[] = {cpp_array(model[key])};")
+        print(f"        constexpr float denseBias = {model['dense_bias']!r}f;")
+        print(f"        constexpr float expected[numSamples] = {cpp_array(run(model, inputs))};")
+        print("    }\n")
+
+    print("}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+
+    First checks AmpModel against fixed-weight lstm and gru models with pytorch reference
+    outputs (ReferenceModels.h), then times the plugin's whole amp model path
+    (AmpModelChain, the same code processBlock runs) on one core. A timing run fails if
+    its p99.9 block misses the deadline or the average load goes over maxAverageLoad.
+
+        AmpModelBenchmark                 benchmarks random lstm and gru models at a few sizes
+        AmpModelBenchmark model.json      benchmarks a real capture
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../SimpleDistortion/Source/AmpModelChain.h"
+#include "ReferenceModels.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+    constexpr int blockSize = 128;
+    constexpr double secondsOfAudio = 10.0;
+    constexpr int warmUpBlocks = 16; //first touches of the scratch and caches, not counted
+
+    //one instance shouldn't take more than a quarter of the core, a session has other plugins in it too
+    constexpr double maxAverageLoad = 0.25;
+
+    //gate on a high percentile, one preemption on a busy machine is the scheduler's fault, not the model's
+    constexpr double blockPercentile = 0.999;
+
+    //float against double precision and the fast tanh, a swapped gate is off by more than 0.1
+    constexpr float referenceTolerance = 1.0e-4f;
+
+    juce::var randomArray(juce::Random& random, int size, float scale)
+    {
+        juce::Array<juce::var> values;
+        for (int i = 0; i < size; ++i) {
+            values.add((random.nextFloat() * 2.f - 1.f) * scale);
+        }
+        return values;
+    }
+
+    //same layout AmpModel::loadFromFile reads, filled with small random weights
+    juce::File writeRandomModel(const juce::String& type, int hiddenSize)
+    {
+        juce::Random random(1234);
+        auto numGates = hiddenSize * (type == "lstm" ? 4 : 3);
+        auto scale = 1.f / std::sqrt((float)hiddenSize);
+
+        auto* model = new juce::DynamicObject();
+        model->setProperty("name", type + " " + juce::String(hiddenSize));
+        model->setProperty("type", type);
+        model->setProperty("hidden_size", hiddenSize);
+        model->setProperty("skip", true);
+        model->setProperty("weight_ih", randomArray(random, numGates, scale));
+        model->setProperty("weight_hh", randomArray(random, numGates * hiddenSize, scale));
+        model->setProperty("bias_ih", randomArray(random, numGates, scale));
+        model->setProperty("bias_hh", randomArray(random, numGates, scale));
+        model->setProperty("dense_weight", randomArray(random, hiddenSize, scale));
+        model->setProperty("dense_bias", 0.f);
+
+        auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getChildFile("AmpModelBenchmark_" + type + juce::String(hiddenSize) + ".json");
+        file.replaceWithText(juce::JSON::toString(juce::var(model)));
+        return file;
+    }
+
+    template <size_t size>
+    juce::var toArray(const float (&values)[size])
+    {
+        juce::Array<juce::var> array;
+        for (auto value : values) {
+            array.add(value);
+        }
+        return array;
+    }
+
+    //writes one of the ReferenceModels out in the json layout the plugin loads, so the loader gets checked too
+    template <size_t gates, size_t recurrent, size_t hidden>
+    juce::File writeReferenceModel(const juce::String& type, int hiddenSize,
+                                   const float (&weightIh)[gates], const float (&weightHh)[recurrent],
+                                   const float (&biasIh)[gates], const float (&biasHh)[gates],
+                                   const float (&denseWeight)[hidden], float denseBias)
+    {
+        auto* model = new juce::DynamicObject();
+        model->setProperty("name", type + " reference");
+        model->setProperty("type", type);
+        model->setProperty("hidden_size", hiddenSize);
+        model->setProperty("skip", true);
+        model->setProperty("weight_ih", toArray(weightIh));
+        model->setProperty("weight_hh", toArray(weightHh));
+        model->setProperty("bias_ih", toArray(biasIh));
+        model->setProperty("bias_hh", toArray(biasHh));
+        model->setProperty("dense_weight", toArray(denseWeight));
+        model->setProperty("dense_bias", denseBias);
+
+        auto file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getChildFile("AmpModelBenchmark_" + type + "_reference.json");
+        file.replaceWithText(juce::JSON::toString(juce::var(model)));
+        return file;
+    }
+
+    //Runs the reference input through both channels in blocks of 5, so the piecewise and stereo paths are covered,
+    //and compares every sample with the pytorch output.
+    bool checkReference(const juce::String& type, const juce::File& file, const float* expected)
+    {
+        juce::String error;
+        auto model = AmpModel::loadFromFile(file, error);
+
+        if (model == nullptr) {
+            std::cout << type << " reference: " << error << "  FAIL" << std::endl;
+            return false;
+        }
+
+        model->prepare(5);
+
+        juce::AudioBuffer<float> buffer(numChannels, ReferenceModels::numSamples);
+        for (int channel = 0; channel < numChannels; ++channel) {
+            buffer.copyFrom(channel, 0, ReferenceModels::input, ReferenceModels::numSamples);
+        }
+
+        model->process(buffer.getArrayOfWritePointers(), numChannels, ReferenceModels::numSamples);
+
+        auto worstError = 0.f;
+        for (int channel = 0; channel < numChannels; ++channel) {
+            for (int sample = 0; sample < ReferenceModels::numSamples; ++sample) {
+                worstError = juce::jmax(worstError, std::abs(buffer.getSample(channel, sample) - expected[sample]));
+            }
+        }
+
+        auto passed = worstError <= referenceTolerance;
+        std::cout << type << " reference: largest error " << worstError << (passed ? "" : "  FAIL") << std::endl;
+        return passed;
+    }
+
+    //returns true if the model's p99.9 block was inside its deadline and it stayed under maxAverageLoad
+    bool benchmark(const juce::File& file)
+    {
+        juce::String error;
+        auto model = AmpModel::loadFromFile(file, error);
+
+        if (model == nullptr) {
+            std::cout << file.getFileName() << ": " << error << std::endl;
+            return false;
+        }
+
+        model->prepare(blockSize);
+
+        //non default settings so every emphasis stage is doing real work
+        EmphasisFilter::Settings settings;
+        settings.tilt = 6.f;
+        settings.highPass = 80.f;
+        settings.lowPass = 8000.f;
+        settings.midGain = 4.f;
+
+        EmphasisFilter emphasis;
+        emphasis.prepare(sampleRate, settings);
+
+        AmpModelChain chain;
+        chain.prepare(numChannels, blockSize);
+
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::Random random;
+        auto numBlocks = static_cast<int>(secondsOfAudio * sampleRate / blockSize);
+
+        std::vector<double> blockTimes;
+        blockTimes.reserve(static_cast<size_t>(numBlocks));
+
+        for (int block = 0; block < numBlocks + warmUpBlocks; ++block) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                auto* data = buffer.getWritePointer(channel);
+                for (int sample = 0; sample < blockSize; ++sample) {
+                    data[sample] = random.nextFloat() * 2.f - 1.f;
+                }
+            }
+
+            auto blockStart = juce::Time::getHighResolutionTicks();
+            chain.process(*model, emphasis, buffer, numChannels, 5.f, 0.2f, 0.8f);
+            auto blockTime = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStart);
+
+            if (block >= warmUpBlocks) {
+                blockTimes.push_back(blockTime);
+            }
+        }
+
+        std::sort(blockTimes.begin(), blockTimes.end());
+
+        auto percentileIndex = static_cast<size_t>(blockPercentile * static_cast<double>(blockTimes.size() - 1));
+        auto percentileBlock = blockTimes[percentileIndex];
+        auto worstBlock = blockTimes.back(); //printed only, see blockPercentile
+
+        auto deadline = blockSize / sampleRate;
+        auto averageLoad = std::accumulate(blockTimes.begin(), blockTimes.end(), 0.0) / secondsOfAudio;
+        auto passed = percentileBlock <= deadline && averageLoad <= maxAverageLoad;
+
+        std::cout << model->getName() << " (" << model->getNumWeights() << " weights): average load "
+                  << juce::String(averageLoad * 100.0, 1) << "% (limit " << juce::String(maxAverageLoad * 100.0, 0)
+                  << "%), p99.9 block " << juce::String(percentileBlock * 1000.0, 3) << " ms of "
+                  << juce::String(deadline * 1000.0, 3) << " ms, worst " << juce::String(worstBlock * 1000.0, 3)
+                  << " ms" << (passed ? "" : "  FAIL") << std::endl;
+
+        return passed;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    std::cout << "Amp model benchmark, " << numChannels << " channels at " << sampleRate
+              << " Hz in blocks of " << blockSize << std::endl;
+
+    juce::Array<juce::File> models;
+
+    if (argc > 1) {
+        models.add(juce::File::getCurrentWorkingDirectory().getChildFile(argv[1]));
+    }
+    else {
+        for (auto type : { "lstm", "gru" }) {
+            for (auto hiddenSize : { 8, 16, 32 }) {
+                models.add(writeRandomModel(type, hiddenSize));
+            }
+        }
+    }
+
+    namespace lstm = ReferenceModels::lstm;
+    namespace gru = ReferenceModels::gru;
+
+    auto allPassed = checkReference("lstm", writeReferenceModel("lstm", lstm::hiddenSize, lstm::weightIh, lstm::weightHh, lstm::biasIh,
+                                                                lstm::biasHh, lstm::denseWeight, lstm::denseBias), lstm::expected);
+    allPassed = checkReference("gru", writeReferenceModel("gru", gru::hiddenSize, gru::weightIh, gru::weightHh, gru::biasIh,
+                                                          gru::biasHh, gru::denseWeight, gru::denseBias), gru::expected) && allPassed;
+
+    for (auto& file : models) {
+        allPassed = benchmark(file) && allPassed;
+    }
+
+    return allPassed ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+//Generated by Reference/make_reference.py, don't edit by hand
+#pragma once
+
+namespace ReferenceModels
+{
+    constexpr int numSamples = 16;
+    constexpr float input[numSamples] = { 0.3f, 0.3155f, 0.7547f, 0.9353f, -0.0245f, -0.1356f, -0.598f, -1.0632f, -0.2348f, -0.0694f, 0.3657f, 1.0863f, 0.4493f, 0.2717f, -0.0808f, -1.0033f };
+
+    namespace lstm
+    {
+        constexpr int hiddenSize = 3;
+        constexpr float weightIh[] = { 0.2465f, -0.0698f, -0.1134f, 0.2861f, -0.432f, 0.5376f, -0.593f, 0.5929f, -0.5376f, 0.4319f, -0.286f, 0.1133f };
+        constexpr float weightHh[] = { 0.4495f, -0.3085f, 0.1387f, 0.0441f, -0.2228f, 0.3806f, -0.5029f, 0.5783f, -0.5996f, 0.5649f, -0.4775f, 0.3454f, -0.1811f, -0.0001f, 0.1813f, -0.3456f, 0.4776f, -0.565f, 0.5996f, -0.5782f, 0.5028f, -0.3805f, 0.2226f, -0.0439f, -0.1389f, 0.3087f, -0.4497f, 0.5486f, -0.5964f, 0.5884f, -0.5255f, 0.4135f, -0.2629f, 0.0877f, 0.0957f, -0.2701f };
+        constexpr float biasIh[] = { 0.5731f, -0.4927f, 0.3663f, -0.2056f, 0.0258f, 0.1564f, -0.3241f, 0.4615f, -0.5557f, 0.5981f, -0.5846f, 0.5165f };
+        constexpr float biasHh[] = { 0.5955f, -0.5899f, 0.5292f, -0.4191f, 0.2698f, -0.0954f, -0.088f, 0.2631f, -0.4137f, 0.5256f, -0.5885f, 0.5963f };
+        constexpr float denseWeight[] = { 0.5127f, -0.5829f, 0.5986f };
+        constexpr float denseBias = 0.05f;
+        constexpr float expected[numSamples] = { -0.06235015605936478f, -0.22690939284441813f, 0.10034368764125334f, 0.2338802265633647f, -0.6538317182768343f, -0.7368326009478938f, -1.0975220748699506f, -1.3694986743707664f, -0.6686962587757392f, -0.5855534264574017f, -0.24539950566361257f, 0.3814282589684759f, -0.22653413995094446f, -0.39184812133298313f, -0.7027168834020487f, -1.4197410445999774f };
+    }
+
+    namespace gru
+    {
+        constexpr int hiddenSize = 3;
+        constexpr float weightIh[] = { 0.2465f, -0.0698f, -0.1134f, 0.2861f, -0.432f, 0.5376f, -0.593f, 0.5929f, -0.5376f };
+        constexpr float weightHh[] = { 0.4495f, -0.3085f, 0.1387f, 0.0441f, -0.2228f, 0.3806f, -0.5029f, 0.5783f, -0.5996f, 0.5649f, -0.4775f, 0.3454f, -0.1811f, -0.0001f, 0.1813f, -0.3456f, 0.4776f, -0.565f, 0.5996f, -0.5782f, 0.5028f, -0.3805f, 0.2226f, -0.0439f, -0.1389f, 0.3087f, -0.4497f };
+        constexpr float biasIh[] = { 0.5731f, -0.4927f, 0.3663f, -0.2056f, 0.0258f, 0.1564f, -0.3241f, 0.4615f, -0.5557f };
+        constexpr float biasHh[] = { 0.5955f, -0.5899f, 0.5292f, -0.4191f, 0.2698f, -0.0954f, -0.088f, 0.2631f, -0.4137f };
+        constexpr float denseWeight[] = { 0.5127f, -0.5829f, 0.5986f };
+        constexpr float denseBias = 0.05f;
+        constexpr float expected[numSamples] = { -0.18290724614304454f, -0.48677558759972117f, -0.2879178612636276f, -0.2376212621003504f, -1.0763172057375223f, -1.0943684105240794f, -1.3354497332884634f, -1.4568410294289484f, -0.8181431021614761f, -0.8103831882630922f, -0.5696813139449414f, -0.05091166161538663f, -0.6908188666278077f, -0.8364142422694456f, -1.0837678880738026f, -1.5753386393007998f };
+    }
+
+}
@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+    AmpModel.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AmpModel.h"
+
+namespace
+{
+    //pulls every number out of a (possibly nested) json array, in row order
+    bool flatten(const juce::var& value, std::vector<float>& out)
+    {
+        if (auto* array = value.getArray()) {
+            for (auto& element : *array) {
+                if (!flatten(element, out))
+                    return false;
+            }
+            return true;
+        }
+
+        if (value.isDouble() || value.isInt() || value.isInt64()) {
+            out.push_back(static_cast<float>(value));
+            return true;
+        }
+
+        return false;
+    }
+
+    bool readWeights(const juce::var& json, const char* key, size_t expectedSize, std::vector<float>& out, juce::String& error)
+    {
+        out.clear();
+
+        if (!flatten(json.getProperty(key, {}), out) || out.size() != expectedSize) {
+            error = juce::String("\"") + key + "\" should hold " + juce::String((int)expectedSize) + " numbers";
+            return false;
+        }
+
+        return true;
+    }
+
+    //The rational approximation is only good between -5 and 5, so clip first. Both loops are plain enough for the compiler to vectorise.
+    inline void tanhInPlace(float* data, int num) noexcept
+    {
+        juce::FloatVectorOperations::clip(data, data, -5.f, 5.f, num);
+
+        for (int i = 0; i < num; ++i)
+            data[i] = juce::dsp::FastMathApproximations::tanh(data[i]);
+    }
+
+    //sigmoid(x) = 0.5 * tanh(0.5 * x) + 0.5
+    inline void sigmoidInPlace(float* data, int num) noexcept
+    {
+        juce::FloatVectorOperations::multiply(data, 0.5f, num);
+        tanhInPlace(data, num);
+        juce::FloatVectorOperations::multiply(data, 0.5f, num);
+        juce::FloatVectorOperations::add(data, 0.5f, num);
+    }
+}
+
+//==============================================================================
+std::unique_ptr<AmpModel> AmpModel::loadFromFile(const juce::File& file, juce::String& error)
+{
+    if (!file.existsAsFile()) {
+        error = file.getFullPathName() + " doesn't exist";
+        return nullptr;
+    }
+
+    auto json = juce::JSON::parse(file);
+
+    if (!json.isObject()) {
+        error = "Couldn't read " + file.getFileName() + " as a json amp model";
+        return nullptr;
+    }
+
+    std::unique_ptr<AmpModel> model(new AmpModel());
+
+    model->name = json.getProperty("name", file.getFileNameWithoutExtension()).toString();
+    model->skip = static_cast<bool>(json.getProperty("skip", false));
+
+    auto type = json.getProperty("type", "lstm").toString().toLowerCase();
+
+    if (type == "lstm") {
+        model->cellType = CellType::lstm;
+    }
+    else if (type == "gru") {
+        model->cellType = CellType::gru;
+    }
+    else {
+        error = "Unknown model type \"" + type + "\", expected lstm or gru";
+        return nullptr;
+    }
+
+    auto hiddenSize = static_cast<int>(json.getProperty("hidden_size", 0));
+
+    if (hiddenSize < 1 || hiddenSize > maxHiddenSize) {
+        error = "hidden_size has to be between 1 and " + juce::String(maxHiddenSize);
+        return nullptr;
+    }
+
+    auto numGates = hiddenSize * (model->cellType == CellType::lstm ? 4 : 3);
+    auto gates = static_cast<size_t>(numGates);
+    auto hidden = static_cast<size_t>(hiddenSize);
+
+    model->hiddenSize = hiddenSize;
+    model->numGates = numGates;
+
+    std::vector<float> rowMajor, recurrentBias;
+
+    if (!readWeights(json, "weight_ih", gates, model->inputWeights, error)
+        || !readWeights(json, "weight_hh", gates * hidden, rowMajor, error)
+        || !readWeights(json, "bias_ih", gates, model->inputBias, error)
+        || !readWeights(json, "bias_hh", gates, recurrentBias, error)
+        || !readWeights(json, "dense_weight", hidden, model->outputWeights, error)) {
+        return nullptr;
+    }
+
+    std::vector<float> denseBias;
+    if (!flatten(json.getProperty("dense_bias", 0), denseBias) || denseBias.size() != 1) {
+        error = "\"dense_bias\" should be a single number";
+        return nullptr;
+    }
+    model->outputBias = denseBias[0];
+
+    //flip to column major so the recurrent matrix multiply is one vector add per hidden unit
+    model->recurrentWeights.resize(gates * hidden);
+    for (size_t row = 0; row < gates; ++row) {
+        for (size_t column = 0; column < hidden; ++column) {
+            model->recurrentWeights[column * gates + row] = rowMajor[row * hidden + column];
+        }
+    }
+
+    //the lstm adds both biases straight away, the gru needs the hidden one on its own for the candidate gate
+    if (model->cellType == CellType::lstm) {
+        juce::FloatVectorOperations::add(model->inputBias.data(), recurrentBias.data(), numGates);
+    }
+    else {
+        model->recurrentBias = std::move(recurrentBias);
+    }
+
+    for (auto& state : model->states) {
+        state.hidden.resize(hidden);
+        state.cell.resize(hidden);
+        state.recurrent.resize(gates);
+    }
+
+    model->reset();
+    return model;
+}
+
+void AmpModel::prepare(int newMaxBlockSize)
+{
+    maxBlockSize = juce::jmax(1, newMaxBlockSize);
+
+    for (auto& state : states) {
+        state.projection.resize(static_cast<size_t>(numGates) * static_cast<size_t>(maxBlockSize));
+    }
+}
+
+void AmpModel::reset() noexcept
+{
+    for (auto& state : states) {
+        std::fill(state.hidden.begin(), state.hidden.end(), 0.f);
+        std::fill(state.cell.begin(), state.cell.end(), 0.f);
+    }
+}
+
+int AmpModel::getNumWeights() const noexcept
+{
+    return static_cast<int>(inputWeights.size() + recurrentWeights.size() + inputBias.size()
+                            + recurrentBias.size() + outputWeights.size()) + 1;
+}
+
+//==============================================================================
+void AmpModel::process(float* const* channels, int numChannels, int numSamples) noexcept
+{
+    jassert(maxBlockSize > 0); //prepare() hasn't been called
+    jassert(numChannels > 0 && numChannels <= maxChannels);
+    numChannels = juce::jlimit(0, maxChannels, numChannels);
+
+    float* gates[maxChannels] = {};
+
+    //hosts can go over the block size they promised, so work through it in pieces that fit the scratch
+    for (int start = 0; start < numSamples && maxBlockSize > 0; start += maxBlockSize) {
+        auto blockLength = juce::jmin(maxBlockSize, numSamples - start);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            project(channels[channel] + start, states[channel], blockLength);
+        }
+
+        for (int sample = 0; sample < blockLength; ++sample) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                gates[channel] = states[channel].projection.data() + sample * numGates;
+            }
+
+            if (cellType == CellType::lstm) {
+                addRecurrent(gates, numChannels);
+
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    activateLstm(states[channel], gates[channel]);
+                }
+            }
+            else {
+                //the gru needs the recurrent half on its own for the candidate gate
+                float* recurrent[maxChannels] = {};
+
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    recurrent[channel] = states[channel].recurrent.data();
+                    juce::FloatVectorOperations::copy(recurrent[channel], recurrentBias.data(), numGates);
+                }
+
+                addRecurrent(recurrent, numChannels);
+
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    activateGru(states[channel], gates[channel]);
+                }
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel) {
+                auto& data = channels[channel][start + sample];
+                data = output(states[channel], data);
+            }
+        }
+    }
+}
+
+void AmpModel::project(const float* input, State& state, int numSamples) noexcept
+{
+    //bias + W_ih * x for the whole block, one row of numGates per sample
+    auto* projection = state.projection.data();
+    auto* bias = inputBias.data();
+    auto* weights = inputWeights.data();
+
+    for (int sample = 0; sample < numSamples; ++sample, projection += numGates) {
+        auto x = input[sample];
+
+        for (int gate = 0; gate < numGates; ++gate) {
+            projection[gate] = bias[gate] + weights[gate] * x;
+        }
+    }
+}
+
+void AmpModel::addRecurrent(float* const* gates, int numChannels) noexcept
+{
+    //gates += W_hh * h, a column at a time so each column load is shared by both channels
+    auto* column = recurrentWeights.data();
+
+    if (numChannels == 2) {
+        float* __restrict left = gates[0];
+        float* __restrict right = gates[1];
+        const float* leftHidden = states[0].hidden.data();
+        const float* rightHidden = states[1].hidden.data();
+
+        for (int unit = 0; unit < hiddenSize; ++unit, column += numGates) {
+            auto l = leftHidden[unit];
+            auto r = rightHidden[unit];
+
+            for (int gate = 0; gate < numGates; ++gate) {
+                left[gate] += column[gate] * l;
+                right[gate] += column[gate] * r;
+            }
+        }
+    }
+    else {
+        const float* hidden = states[0].hidden.data();
+
+        for (int unit = 0; unit < hiddenSize; ++unit, column += numGates) {
+            juce::FloatVectorOperations::addWithMultiply(gates[0], column, hidden[unit], numGates);
+        }
+    }
+}
+
+void AmpModel::activateLstm(State& state, float* gates) noexcept
+{
+    using FVO = juce::FloatVectorOperations;
+
+    auto* hidden = state.hidden.data();
+    auto* cell = state.cell.data();
+    auto h = hiddenSize;
+
+    //gates are laid out as input, forget, cell and output
+    sigmoidInPlace(gates, 2 * h);
+    tanhInPlace(gates + 2 * h, h);
+    sigmoidInPlace(gates + 3 * h, h);
+
+    //c = f * c + i * g
+    FVO::multiply(cell, gates + h, h);
+    FVO::addWithMultiply(cell, gates, gates + 2 * h, h);
+
+    //h = o * tanh(c)
+    FVO::copy(hidden, cell, h);
+    tanhInPlace(hidden, h);
+    FVO::multiply(hidden, gates + 3 * h, h);
+}
+
+void AmpModel::activateGru(State& state, float* gates) noexcept
+{
+    using FVO = juce::FloatVectorOperations;
+
+    auto* recurrent = state.recurrent.data();
+    auto* hidden = state.hidden.data();
+    auto h = hiddenSize;
+
+    //gates are laid out as reset, update and candidate. r and z first
+    FVO::add(gates, recurrent, 2 * h);
+    sigmoidInPlace(gates, 2 * h);
+
+    //n = tanh(input part + r * hidden part)
+    FVO::addWithMultiply(gates + 2 * h, gates, recurrent + 2 * h, h);
+    tanhInPlace(gates + 2 * h, h);
+
+    //h = (1 - z) * n + z * h, which is n + z * (h - n)
+    FVO::subtract(hidden, gates + 2 * h, h);
+    FVO::multiply(hidden, gates + h, h);
+    FVO::add(hidden, gates + 2 * h, h);
+}
+
+float AmpModel::output(const State& state, float input) const noexcept
+{
+    auto out = std::inner_product(outputWeights.begin(), outputWeights.end(), state.hidden.begin(), outputBias);
+    return skip ? out + input : out;
+}
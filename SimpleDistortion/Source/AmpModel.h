@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    AmpModel.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A small recurrent amp capture (one LSTM or GRU layer into a single dense output),
+    used as an alternative to the tanh curve in processBlock.
+
+    Models are loaded from a json file laid out like a pytorch state dict:
+
+        {
+            "name": "My Amp",             (optional, defaults to the file name)
+            "type": "lstm",               ("lstm" or "gru")
+            "hidden_size": 16,
+            "skip": true,                 (optional, adds the input back onto the output)
+            "weight_ih": [...],           (gates * hidden_size values, flat or nested)
+            "weight_hh": [...],           (gates * hidden_size rows of hidden_size values)
+            "bias_ih": [...],
+            "bias_hh": [...],
+            "dense_weight": [...],        (hidden_size values)
+            "dense_bias": 0.0
+        }
+
+    Every size is fixed when the file is loaded and prepare() is called, so process() never allocates.
+*/
+class AmpModel
+{
+public:
+    enum class CellType { lstm, gru };
+
+    //one state per channel, the buses only allow mono or stereo
+    static constexpr int maxChannels = 2;
+    static constexpr int maxHiddenSize = 64;
+
+    //Returns nullptr and fills in error if the file can't be used. Call this off the audio thread.
+    static std::unique_ptr<AmpModel> loadFromFile(const juce::File& file, juce::String& error);
+
+    //sizes the per block scratch, call before process() and whenever the block size changes
+    void prepare(int maxBlockSize);
+    void reset() noexcept;
+
+    /*  Runs the model over a block of every channel in place.
+
+        The input half of each gate (bias + W_ih * x) is worked out for the whole block first,
+        so the per sample loop is only the recurrent matrix multiply, and that runs every
+        channel together so each weight column is loaded once for all of them.
+    */
+    void process(float* const* channels, int numChannels, int numSamples) noexcept;
+
+    const juce::String& getName() const noexcept { return name; }
+    CellType getCellType() const noexcept { return cellType; }
+    int getHiddenSize() const noexcept { return hiddenSize; }
+    int getNumWeights() const noexcept;
+
+private:
+    AmpModel() = default;
+
+    struct State
+    {
+        std::vector<float> hidden, cell;
+        std::vector<float> recurrent;   //gru only, W_hh * h kept apart from the input half
+        std::vector<float> projection;  //numGates per sample of the block, the gates are finished in place
+    };
+
+    void project(const float* input, State& state, int numSamples) noexcept;
+    void addRecurrent(float* const* gates, int numChannels) noexcept;
+    void activateLstm(State& state, float* gates) noexcept;
+    void activateGru(State& state, float* gates) noexcept;
+    float output(const State& state, float input) const noexcept;
+
+    juce::String name;
+    CellType cellType = CellType::lstm;
+    int hiddenSize = 0;
+    int numGates = 0; //gate rows, 4 * hiddenSize for lstm and 3 * hiddenSize for gru
+    bool skip = false;
+
+    std::vector<float> inputWeights;      //numGates, the input is a single sample
+    std::vector<float> recurrentWeights;  //column major, hiddenSize columns of numGates so each step is a run of vector adds
+    std::vector<float> inputBias;         //lstm folds both biases in here
+    std::vector<float> recurrentBias;     //gru only, its candidate gate needs the hidden bias kept apart
+    std::vector<float> outputWeights;
+    float outputBias = 0.f;
+
+    State states[maxChannels];
+    int maxBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AmpModel)
+};
@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+    AmpModelChain.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "AmpModelChain.h"
+
+void AmpModelChain::prepare(int numChannels, int maxBlockSize)
+{
+    dryBuffer.setSize(numChannels, maxBlockSize);
+}
+
+void AmpModelChain::process(AmpModel& model, EmphasisFilter& emphasis, juce::AudioBuffer<float>& buffer, int numChannels,
+                            float gain, float blendAmount, float volumeAmount) noexcept
+{
+    auto numSamples = buffer.getNumSamples();
+    auto maxPiece = dryBuffer.getNumSamples();
+
+    jassert(maxPiece > 0); //prepare() hasn't been called
+    numChannels = juce::jmin(juce::jmin(numChannels, AmpModel::maxChannels), buffer.getNumChannels(), dryBuffer.getNumChannels());
+
+    //hosts can go over the block size they promised, so work through it in pieces that fit the clean copy
+    for (int start = 0; start < numSamples && maxPiece > 0; start += maxPiece)
+    {
+        processPiece(model, emphasis, buffer.getArrayOfWritePointers(), numChannels,
+                     start, juce::jmin(maxPiece, numSamples - start), gain, blendAmount, volumeAmount);
+    }
+}
+
+void AmpModelChain::processPiece(AmpModel& model, EmphasisFilter& emphasis, float* const* channels, int numChannels,
+                                 int startSample, int numSamples, float gain, float blendAmount, float volumeAmount) noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        dryBuffer.copyFrom(channel, 0, channels[channel] + startSample, numSamples);
+    }
+
+    //Normally the whole piece goes through in one go. While the emphasis settings are gliding their
+    //coefficients move every smoothingInterval samples, so the chain runs in chunks that size instead.
+    auto chunkSize = emphasis.isSmoothing() ? EmphasisFilter::smoothingInterval : numSamples;
+    float* chunk[AmpModel::maxChannels] = {};
+
+    for (int offset = 0; offset < numSamples; offset += chunkSize)
+    {
+        auto chunkStart = startSample + offset;
+        auto chunkLength = juce::jmin(chunkSize, numSamples - offset);
+        emphasis.advance(chunkLength);
+        emphasis.processPre(channels, numChannels, chunkStart, chunkLength);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            chunk[channel] = channels[channel] + chunkStart;
+            juce::FloatVectorOperations::multiply(chunk[channel], gain, chunkLength);
+        }
+
+        model.process(chunk, numChannels, chunkLength);
+
+        emphasis.processPost(channels, numChannels, chunkStart, chunkLength);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* channelData = channels[channel] + startSample;
+
+        //same mix as the tanh path, (wet * (1 - blend) + clean * blend) / 2 * volume
+        juce::FloatVectorOperations::multiply(channelData, (1.f - blendAmount) * 0.5f * volumeAmount, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(channelData, dryBuffer.getReadPointer(channel), blendAmount * 0.5f * volumeAmount, numSamples);
+    }
+}
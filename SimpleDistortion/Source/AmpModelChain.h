@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    AmpModelChain.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AmpModel.h"
+#include "EmphasisFilter.h"
+
+//==============================================================================
+/**
+    Everything processBlock does to a buffer when the engine is "Amp Model": keep the clean
+    signal, pre-emphasis, drive, the model, de-emphasis, then the blend and volume mix.
+    It's its own class so AmpModelBenchmark times exactly what the plugin runs.
+*/
+class AmpModelChain
+{
+public:
+    //allocates the clean copy, call from prepareToPlay. process() never resizes it.
+    void prepare(int numChannels, int maxBlockSize);
+
+    void process(AmpModel& model, EmphasisFilter& emphasis, juce::AudioBuffer<float>& buffer, int numChannels,
+                 float gain, float blendAmount, float volumeAmount) noexcept;
+
+private:
+    void processPiece(AmpModel& model, EmphasisFilter& emphasis, float* const* channels, int numChannels,
+                      int startSample, int numSamples, float gain, float blendAmount, float volumeAmount) noexcept;
+
+    juce::AudioBuffer<float> dryBuffer;
+};
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    EmphasisFilter.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "EmphasisFilter.h"
+
+namespace
+{
+    constexpr float tiltFrequency = 1000.f;
+    constexpr float shelfQ = 0.707f;
+    constexpr float midQ = 0.7f;
+    constexpr double rampSeconds = 0.05;
+
+    //passes the signal straight through, in the b0 b1 b2 a0 a1 a2 order ArrayCoefficients uses
+    constexpr std::array<float, 6> identity{ { 1.f, 0.f, 0.f, 1.f, 0.f, 0.f } };
+}
+
+bool EmphasisFilter::Settings::operator== (const Settings& other) const noexcept
+{
+    return tilt == other.tilt && highPass == other.highPass && lowPass == other.lowPass
+        && midFrequency == other.midFrequency && midGain == other.midGain;
+}
+
+void EmphasisFilter::prepare(double newSampleRate, const Settings& settings) noexcept
+{
+    sampleRate = newSampleRate;
+    targets = settings;
+
+    tilt.reset(sampleRate, rampSeconds);
+    highPass.reset(sampleRate, rampSeconds);
+    lowPass.reset(sampleRate, rampSeconds);
+    midFrequency.reset(sampleRate, rampSeconds);
+    midGain.reset(sampleRate, rampSeconds);
+
+    tilt.setCurrentAndTargetValue(settings.tilt);
+    highPass.setCurrentAndTargetValue(settings.highPass);
+    lowPass.setCurrentAndTargetValue(settings.lowPass);
+    midFrequency.setCurrentAndTargetValue(settings.midFrequency);
+    midGain.setCurrentAndTargetValue(settings.midGain);
+
+    updateCoefficients();
+    reset();
+}
+
+void EmphasisFilter::reset() noexcept
+{
+    pre.reset();
+    post.reset();
+}
+
+void EmphasisFilter::setSettings(const Settings& newSettings) noexcept
+{
+    if (newSettings == targets) {
+        return;
+    }
+
+    targets = newSettings;
+
+    tilt.setTargetValue(targets.tilt);
+    highPass.setTargetValue(targets.highPass);
+    lowPass.setTargetValue(targets.lowPass);
+    midFrequency.setTargetValue(targets.midFrequency);
+    midGain.setTargetValue(targets.midGain);
+}
+
+bool EmphasisFilter::isSmoothing() const noexcept
+{
+    return tilt.isSmoothing() || highPass.isSmoothing() || lowPass.isSmoothing()
+        || midFrequency.isSmoothing() || midGain.isSmoothing();
+}
+
+void EmphasisFilter::advance(int numSamples) noexcept
+{
+    if (!isSmoothing()) {
+        return;
+    }
+
+    tilt.skip(numSamples);
+    highPass.skip(numSamples);
+    lowPass.skip(numSamples);
+    midFrequency.skip(numSamples);
+    midGain.skip(numSamples);
+
+    updateCoefficients();
+}
+
+void EmphasisFilter::updateCoefficients() noexcept
+{
+    //ArrayCoefficients hands back plain arrays, so unlike IIR::Coefficients nothing here allocates on the audio thread
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<float>;
+
+    auto nyquistLimit = static_cast<float>(sampleRate * 0.45);
+    //a tilt is both shelves at the same corner, treble up by half the setting and bass down by the other half
+    auto tiltGain = juce::Decibels::decibelsToGain(tilt.getCurrentValue() * 0.5f);
+    auto midGainFactor = juce::Decibels::decibelsToGain(midGain.getCurrentValue());
+    auto midFreq = juce::jmin(midFrequency.getCurrentValue(), nyquistLimit);
+
+    //at the ends of their ranges the high and low pass are switched out, so the default sound is the plain shaper
+    auto highPassFreq = highPass.getCurrentValue();
+    auto lowPassFreq = lowPass.getCurrentValue();
+
+    pre.setStage(0, highPassFreq <= highPassOff ? identity : Coefficients::makeHighPass(sampleRate, juce::jmin(highPassFreq, nyquistLimit)));
+    pre.setStage(1, Coefficients::makeLowShelf(sampleRate, tiltFrequency, shelfQ, 1.f / tiltGain));
+    pre.setStage(2, Coefficients::makeHighShelf(sampleRate, tiltFrequency, shelfQ, tiltGain));
+    pre.setStage(3, Coefficients::makePeakFilter(sampleRate, midFreq, midQ, midGainFactor));
+
+    //inverting the gain gives the exact inverse of the shelves and peak above
+    post.setStage(0, Coefficients::makeLowShelf(sampleRate, tiltFrequency, shelfQ, tiltGain));
+    post.setStage(1, Coefficients::makeHighShelf(sampleRate, tiltFrequency, shelfQ, 1.f / tiltGain));
+    post.setStage(2, Coefficients::makePeakFilter(sampleRate, midFreq, midQ, 1.f / midGainFactor));
+    post.setStage(3, lowPassFreq >= lowPassOff ? identity : Coefficients::makeLowPass(sampleRate, juce::jmin(lowPassFreq, nyquistLimit)));
+}
+
+EmphasisFilter::Frame EmphasisFilter::readFrame(const float* const* channels, int numChannels, int sample) noexcept
+{
+    auto frame = Frame::expand(0.f);
+    for (int channel = 0; channel < numChannels; ++channel) {
+        frame.set((size_t)channel, channels[channel][sample]);
+    }
+    return frame;
+}
+
+void EmphasisFilter::writeFrame(Frame frame, float* const* channels, int numChannels, int sample) noexcept
+{
+    for (int channel = 0; channel < numChannels; ++channel) {
+        channels[channel][sample] = frame.get((size_t)channel);
+    }
+}
+
+void EmphasisFilter::processRange(Cascade& cascade, float* const* channels, int numChannels, int startSample, int numSamples) noexcept
+{
+    numChannels = juce::jmin(numChannels, maxChannels);
+
+    for (int sample = startSample; sample < startSample + numSamples; ++sample) {
+        writeFrame(cascade.process(readFrame(channels, numChannels, sample)), channels, numChannels, sample);
+    }
+}
+
+//==============================================================================
+void EmphasisFilter::Cascade::setStage(int index, const std::array<float, 6>& coefficients) noexcept
+{
+    //the arrays come as b0 b1 b2 a0 a1 a2, normalise so a0 is 1
+    auto a0 = coefficients[3];
+    auto& stage = stages[index];
+
+    stage.b0 = coefficients[0] / a0;
+    stage.b1 = coefficients[1] / a0;
+    stage.b2 = coefficients[2] / a0;
+    stage.a1 = coefficients[4] / a0;
+    stage.a2 = coefficients[5] / a0;
+}
+
+void EmphasisFilter::Cascade::reset() noexcept
+{
+    for (auto& stage : stages) {
+        stage.s1 = Frame::expand(0.f);
+        stage.s2 = Frame::expand(0.f);
+    }
+}
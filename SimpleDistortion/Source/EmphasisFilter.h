@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    EmphasisFilter.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Pre-emphasis and de-emphasis around the shaper.
+
+    Before the shaper: high pass, tilt (low and high shelf), mid peak.
+    After the shaper:  the opposite tilt shelves and mid peak, then low pass.
+
+    The tilt and mid boosts are undone after the shaper, so they change what gets distorted
+    without changing the clean tone. Each side is a cascade of transposed direct form II
+    biquads, with every channel in its own lane of a SIMDRegister so one multiply covers
+    all the channels.
+*/
+class EmphasisFilter
+{
+public:
+    using Frame = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxChannels = 2;
+    static_assert(maxChannels <= (int)Frame::SIMDNumElements, "each channel needs its own lane");
+
+    //at these ends of their ranges the high and low pass drop out completely
+    static constexpr float highPassOff = 20.f;
+    static constexpr float lowPassOff = 20000.f;
+
+    //while a setting is gliding the coefficients are recalculated every this many samples
+    static constexpr int smoothingInterval = 32;
+
+    struct Settings
+    {
+        float tilt = 0.f;                   //dB between bass and treble going into the shaper, split evenly around 1 kHz
+        float highPass = highPassOff;       //Hz
+        float lowPass = lowPassOff;         //Hz
+        float midFrequency = 1000.f;        //Hz
+        float midGain = 0.f;                //dB
+
+        bool operator== (const Settings& other) const noexcept;
+    };
+
+    //jumps straight to settings, nothing to glide from yet
+    void prepare(double newSampleRate, const Settings& settings) noexcept;
+    void reset() noexcept;
+
+    //starts a short glide towards newSettings, a no-op if they're the settings we're already heading for
+    void setSettings(const Settings& newSettings) noexcept;
+
+    //Moves any glide on by numSamples and recalculates the coefficients, only while something is actually gliding.
+    //Call once per chunk of at most smoothingInterval samples before processing it.
+    void advance(int numSamples) noexcept;
+    bool isSmoothing() const noexcept;
+
+    //one sample of every channel, used from inside the shaper loop
+    Frame processPre(Frame frame) noexcept { return pre.process(frame); }
+    Frame processPost(Frame frame) noexcept { return post.process(frame); }
+
+    //range versions for the amp model, which runs a block at a time
+    void processPre(float* const* channels, int numChannels, int startSample, int numSamples) noexcept { processRange(pre, channels, numChannels, startSample, numSamples); }
+    void processPost(float* const* channels, int numChannels, int startSample, int numSamples) noexcept { processRange(post, channels, numChannels, startSample, numSamples); }
+
+    static Frame readFrame(const float* const* channels, int numChannels, int sample) noexcept;
+    static void writeFrame(Frame frame, float* const* channels, int numChannels, int sample) noexcept;
+
+private:
+    struct Cascade
+    {
+        static constexpr int numStages = 4;
+
+        struct Stage
+        {
+            float b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+            Frame s1 = Frame::expand(0.f), s2 = Frame::expand(0.f);
+        };
+
+        void setStage(int index, const std::array<float, 6>& coefficients) noexcept;
+        void reset() noexcept;
+
+        Frame process(Frame x) noexcept
+        {
+            for (auto& stage : stages) {
+                auto y = x * stage.b0 + stage.s1;
+                stage.s1 = x * stage.b1 - y * stage.a1 + stage.s2;
+                stage.s2 = x * stage.b2 - y * stage.a2;
+                x = y;
+            }
+            return x;
+        }
+
+        Stage stages[numStages];
+    };
+
+    void processRange(Cascade& cascade, float* const* channels, int numChannels, int startSample, int numSamples) noexcept;
+    void updateCoefficients() noexcept;
+
+    Cascade pre, post;
+    Settings targets;
+    double sampleRate{ 44100.0 };
+
+    juce::SmoothedValue<float> tilt, midGain;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> highPass, lowPass, midFrequency;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EmphasisFilter)
+};
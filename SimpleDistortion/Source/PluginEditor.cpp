@@ -15,7 +15,12 @@ SimpleDistortionAudioProcessorEditor::SimpleDistortionAudioProcessorEditor (Simp
     : AudioProcessorEditor (&p), audioProcessor (p), driveAT(audioProcessor.apvts, "Drive", drive), 
     rangeAT(audioProcessor.apvts, "Range", range), 
     blendAT(audioProcessor.apvts, "Blend", blend), 
-    volumeAT(audioProcessor.apvts, "Volume", volume) //better to use a map as we get more parameters
+    volumeAT(audioProcessor.apvts, "Volume", volume), //better to use a map as we get more parameters
+    tiltAT(audioProcessor.apvts, "Tilt", tilt),
+    highPassAT(audioProcessor.apvts, "HighPass", highPass),
+    lowPassAT(audioProcessor.apvts, "LowPass", lowPass),
+    midFreqAT(audioProcessor.apvts, "MidFreq", midFreq),
+    midGainAT(audioProcessor.apvts, "MidGain", midGain)
 {
     //allow me to overide knobs and create meters
     setLookAndFeel(&laf);
@@ -43,7 +48,27 @@ SimpleDistortionAudioProcessorEditor::SimpleDistortionAudioProcessorEditor (Simp
     volume.setTextBoxStyle(juce::Slider::NoTextBox, false, 100, 20);
     addAndMakeVisible(volume);
 
-    setSize (800, 250);
+    for (auto* knob : { &tilt, &highPass, &lowPass, &midFreq, &midGain }) {
+        knob->setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
+        knob->setTextBoxStyle(juce::Slider::NoTextBox, false, 100, 20);
+        addAndMakeVisible(*knob);
+    }
+
+    //the items have to be there before the attachment picks the saved one
+    if (auto* engineChoice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.apvts.getParameter("Engine"))) {
+        engine.addItemList(engineChoice->choices, 1);
+    }
+    engineAT = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.apvts, "Engine", engine);
+    addAndMakeVisible(engine);
+
+    loadModel.onClick = [this] { chooseAmpModel(); };
+    addAndMakeVisible(loadModel);
+
+    modelName.setText(audioProcessor.getAmpModelStatus(), juce::dontSendNotification);
+    modelName.setColour(juce::Label::textColourId, juce::Colours::whitesmoke);
+    addAndMakeVisible(modelName);
+
+    setSize (800, 370);
 
     startTimerHz(24); //render adjustment at 24 hz
 }
@@ -67,6 +92,29 @@ void SimpleDistortionAudioProcessorEditor::timerCallback()
 
     outMeterL.repaint();
     outMeterR.repaint();
+
+    //the model can also change (or fail to load) when the host restores a session
+    modelName.setText(audioProcessor.getAmpModelStatus(), juce::dontSendNotification);
+}
+
+void SimpleDistortionAudioProcessorEditor::chooseAmpModel()
+{
+    modelChooser = std::make_unique<juce::FileChooser>("Load an amp model", juce::File(), "*.json");
+
+    modelChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles, [this](const juce::FileChooser& chooser)
+    {
+        auto file = chooser.getResult();
+        if (file == juce::File()) {
+            return; //cancelled
+        }
+
+        juce::String error;
+        if (!audioProcessor.loadAmpModel(file, error)) {
+            juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Couldn't load amp model", error);
+        }
+
+        modelName.setText(audioProcessor.getAmpModelStatus(), juce::dontSendNotification);
+    });
 }
 
 //==============================================================================
@@ -82,6 +130,16 @@ void SimpleDistortionAudioProcessorEditor::paint (juce::Graphics& g)
     //g.fillAll (juce::Colour(50u,30u,30u)); //create background
     g.fillAll();
     
+    bounds.removeFromBottom(modelStripHeight); //engine controls live here, see resized
+
+    //labels under the emphasis knobs
+    auto emphasisStrip = bounds.removeFromBottom(emphasisStripHeight);
+    auto emphasisWidth = emphasisStrip.getWidth() / 5;
+    g.setColour(juce::Colours::whitesmoke);
+    g.setFont(13.f);
+    for (auto* name : { "Tilt", "High Pass", "Low Pass", "Mid Freq", "Mid Gain" }) {
+        g.drawFittedText(name, emphasisStrip.removeFromLeft(emphasisWidth).removeFromBottom(20), juce::Justification::centred, 1);
+    }
 
     auto inputMeter = bounds.removeFromLeft(bounds.getWidth() * .125);
     inputMeter = inputMeter.removeFromBottom(bounds.getHeight() * .1);
@@ -137,6 +195,19 @@ void SimpleDistortionAudioProcessorEditor::resized()
 
     auto bounds = getLocalBounds();
 
+    auto modelStrip = bounds.removeFromBottom(modelStripHeight).reduced(5);
+    engine.setBounds(modelStrip.removeFromLeft(150));
+    modelStrip.removeFromLeft(5);
+    loadModel.setBounds(modelStrip.removeFromLeft(110));
+    modelStrip.removeFromLeft(5);
+    modelName.setBounds(modelStrip);
+
+    auto emphasisStrip = bounds.removeFromBottom(emphasisStripHeight);
+    auto emphasisWidth = emphasisStrip.getWidth() / 5;
+    for (auto* knob : { &tilt, &highPass, &lowPass, &midFreq, &midGain }) {
+        knob->setBounds(emphasisStrip.removeFromLeft(emphasisWidth).withTrimmedBottom(20));
+    }
+
     auto inputMeter = bounds.removeFromLeft(bounds.getWidth() * .125);
     auto meterLSide = inputMeter.removeFromLeft(inputMeter.getWidth() * .5);
     meterL.setBounds(meterLSide);
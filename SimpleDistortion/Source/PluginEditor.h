@@ -142,7 +142,10 @@ public:
     
 
 private:
+    void chooseAmpModel();
 
+    static constexpr int modelStripHeight = 30;
+    static constexpr int emphasisStripHeight = 90;
 
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
@@ -160,5 +163,16 @@ private:
     using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     Attachment driveAT, rangeAT, blendAT, volumeAT;
 
+    //smaller knobs for the emphasis filters, in a row above the engine controls
+    juce::Slider tilt, highPass, lowPass, midFreq, midGain;
+    Attachment tiltAT, highPassAT, lowPassAT, midFreqAT, midGainAT;
+
+    //engine picker and amp model loader along the bottom
+    juce::ComboBox engine;
+    juce::TextButton loadModel{ "Load Model" };
+    juce::Label modelName;
+    std::unique_ptr<juce::FileChooser> modelChooser;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> engineAT;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleDistortionAudioProcessorEditor)
 };
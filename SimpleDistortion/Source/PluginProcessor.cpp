@@ -9,6 +9,24 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
+namespace
+{
+    //peak and rms in a single pass over the samples
+    void measureLevels(const float* data, int numSamples, float& peak, float& rms) noexcept
+    {
+        auto maxMagnitude = 0.f;
+        auto sumOfSquares = 0.f;
+
+        for (int i = 0; i < numSamples; ++i) {
+            maxMagnitude = juce::jmax(maxMagnitude, std::abs(data[i]));
+            sumOfSquares += data[i] * data[i];
+        }
+
+        peak = maxMagnitude;
+        rms = numSamples > 0 ? std::sqrt(sumOfSquares / static_cast<float>(numSamples)) : 0.f;
+    }
+}
+
 //==============================================================================
 SimpleDistortionAudioProcessor::SimpleDistortionAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -22,7 +40,15 @@ SimpleDistortionAudioProcessor::SimpleDistortionAudioProcessor()
                        )
 #endif
 {
-
+    //cache the parameters once so processBlock can snapshot them for the telemetry monitor
+    juce::StringArray parameterNames;
+    for (auto* parameter : getParameters()) {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter)) {
+            telemetryParameters.add(ranged);
+            parameterNames.add(ranged->paramID);
+        }
+    }
+    telemetry.setParameterNames(parameterNames);
 }
 
 SimpleDistortionAudioProcessor::~SimpleDistortionAudioProcessor()
@@ -103,6 +129,21 @@ void SimpleDistortionAudioProcessor::prepareToPlay (double sampleRate, int sampl
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
+
+    currentSampleRate = sampleRate;
+    lastBlockStartTicks = 0; //the gap across a restart isn't a late callback
+    clockReferenceTicks = 0;
+    emphasis.prepare(sampleRate, getEmphasisSettings());
+
+    //sized up front so processBlock doesn't have to allocate for the amp model's clean signal or its scratch
+    ampModelChain.prepare(getTotalNumOutputChannels(), samplesPerBlock);
+    currentBlockSize = samplesPerBlock;
+
+    const juce::SpinLock::ScopedLockType lock(ampModelLock);
+    if (ampModel != nullptr) {
+        ampModel->prepare(samplesPerBlock);
+        ampModel->reset();
+    }
 }
 
 void SimpleDistortionAudioProcessor::releaseResources()
@@ -139,6 +180,9 @@ bool SimpleDistortionAudioProcessor::isBusesLayoutSupported (const BusesLayout&
 
 void SimpleDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    //CLOCK_MONOTONIC on linux, which goes through the vdso so timing the block costs no syscalls
+    auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -176,26 +220,63 @@ void SimpleDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     auto range = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Range"));
     auto blend = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Blend"));
     auto volume = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Volume"));
+    auto engine = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("Engine"));
 
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer (channel);
+    //starts a short glide if any of them moved since the last block, coefficients only get recalculated while it runs
+    emphasis.setSettings(getEmphasisSettings());
+
+    //index 1 is "Amp Model". If a new model is being swapped in right now we just use tanh for this block.
+    const juce::SpinLock::ScopedTryLockType modelLock(ampModelLock);
+    auto useAmpModel = engine->getIndex() == 1 && modelLock.isLocked() && ampModel != nullptr;
+
+    if (useAmpModel) {
+        ampModelChain.process(*ampModel, emphasis, buffer, totalNumInputChannels, drive->get() * range->get(), blend->get(), volume->get());
+    }
+    else {
+        //one pass over the buffer, every channel of a sample goes through pre-emphasis, tanh and de-emphasis together
+        auto numChannels = juce::jmin(totalNumInputChannels, EmphasisFilter::maxChannels);
+        auto* const* channels = buffer.getArrayOfWritePointers();
 
-        for (int sample = 0; sample < buffer.getNumSamples(); sample++) {
+        auto gain = drive->get() * range->get();
+        auto wetMix = (1.f - blend->get()) * 0.5f * volume->get();
+        auto cleanMix = blend->get() * 0.5f * volume->get();
 
-            auto cleanSig = *channelData; //gets the clean signal
+        //the whole block is one chunk unless an emphasis setting is gliding, then the coefficients move every smoothingInterval samples
+        auto numSamples = buffer.getNumSamples();
+        auto chunkSize = emphasis.isSmoothing() ? EmphasisFilter::smoothingInterval : numSamples;
 
-            *channelData *= drive->get() * range->get(); //the get method and pointing at the data achive the same result
+        for (int start = 0; start < numSamples; start += chunkSize) {
+            auto chunkEnd = juce::jmin(start + chunkSize, numSamples);
+            emphasis.advance(chunkEnd - start);
 
-            *channelData = ((((2.f / juce::float_Pi) * tanh(*channelData) * (1.f - * blend)) + (cleanSig * *blend)) / 2) * *volume; //clips back down to one, and mixes the cleansig, if present
+            for (int sample = start; sample < chunkEnd; sample++) {
 
-            channelData++;
+                auto cleanSig = EmphasisFilter::readFrame(channels, numChannels, sample); //gets the clean signal
+
+                auto wetSig = emphasis.processPre(cleanSig) * gain;
+
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    wetSig.set((size_t)channel, (2.f / juce::float_Pi) * tanh(wetSig.get((size_t)channel))); //clips back down to one
+                }
+
+                //mixes the cleansig, if present: (wet * (1 - blend) + clean * blend) / 2 * volume
+                wetSig = emphasis.processPost(wetSig) * wetMix + cleanSig * cleanMix;
+
+                EmphasisFilter::writeFrame(wetSig, channels, numChannels, sample);
+            }
         }
     }
 
+    //peak and rms of the output in one pass, shared by the meters and the telemetry
+    float outputPeak[Telemetry::maxChannels] = {};
+    float outputRms[Telemetry::maxChannels] = {};
+    for (int channel = 0; channel < juce::jmin(buffer.getNumChannels(), Telemetry::maxChannels); ++channel) {
+        measureLevels(buffer.getReadPointer(channel), buffer.getNumSamples(), outputPeak[channel], outputRms[channel]);
+    }
+
     //Looks like it works...
-    rmsOutLevelLeft = juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-    rmsOutLevelRight = juce::Decibels::gainToDecibels(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+    rmsOutLevelLeft = juce::Decibels::gainToDecibels(outputRms[0]);
+    rmsOutLevelRight = juce::Decibels::gainToDecibels(outputRms[1]);
 
     //added to fix graphical bug, rms levels when no music was playing was below -60
     if (rmsOutLevelLeft < -60) {
@@ -205,6 +286,7 @@ void SimpleDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
         rmsOutLevelRight = -60;
     }
 
+    publishTelemetry(buffer.getNumSamples(), outputPeak, outputRms, blockStartTicks);
 }
 
 //==============================================================================
@@ -240,6 +322,21 @@ void SimpleDistortionAudioProcessor::setStateInformation (const void* data, int
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid()) {
         apvts.replaceState(tree);
+
+        //bring the amp model back if the session had one, otherwise don't keep playing whatever was loaded before
+        auto modelPath = apvts.state.getProperty("AmpModelPath").toString();
+        if (modelPath.isEmpty()) {
+            clearAmpModel();
+        }
+        else if (!juce::File::isAbsolutePath(modelPath)) {
+            clearAmpModel("Saved amp model path \"" + modelPath + "\" isn't usable");
+        }
+        else {
+            juce::String error;
+            if (!loadAmpModel(juce::File(modelPath), error)) {
+                clearAmpModel(error);
+            }
+        }
     }
 }
 
@@ -271,6 +368,136 @@ float SimpleDistortionAudioProcessor::getOutRMSValue(int channel) //same as abov
     }
 }
 
+bool SimpleDistortionAudioProcessor::loadAmpModel(const juce::File& file, juce::String& error)
+{
+    auto model = AmpModel::loadFromFile(file, error);
+    if (model == nullptr) {
+        const juce::ScopedLock infoLock(ampModelInfoLock);
+        ampModelError = error;
+        return false;
+    }
+
+    model->prepare(currentBlockSize);
+    auto newName = model->getName();
+
+    {
+        const juce::SpinLock::ScopedLockType lock(ampModelLock);
+        std::swap(ampModel, model);
+    }
+
+    //model now holds the old one, and it gets freed here instead of on the audio thread
+    {
+        const juce::ScopedLock infoLock(ampModelInfoLock);
+        ampModelName = newName;
+        ampModelError = {};
+    }
+
+    apvts.state.setProperty("AmpModelPath", file.getFullPathName(), nullptr);
+    return true;
+}
+
+void SimpleDistortionAudioProcessor::clearAmpModel(const juce::String& reason)
+{
+    std::unique_ptr<AmpModel> oldModel;
+
+    {
+        const juce::SpinLock::ScopedLockType lock(ampModelLock);
+        std::swap(ampModel, oldModel);
+    }
+
+    const juce::ScopedLock infoLock(ampModelInfoLock);
+    ampModelName = {};
+    ampModelError = reason;
+}
+
+juce::String SimpleDistortionAudioProcessor::getAmpModelStatus() const
+{
+    const juce::ScopedLock infoLock(ampModelInfoLock);
+
+    if (ampModelName.isNotEmpty()) {
+        return ampModelName;
+    }
+
+    return ampModelError.isNotEmpty() ? "Couldn't load amp model: " + ampModelError : "No model loaded";
+}
+
+void SimpleDistortionAudioProcessor::publishTelemetry(int numSamples, const float* peak, const float* rms, juce::int64 blockStartTicks) noexcept
+{
+    if (!telemetry.isActive()) {
+        return;
+    }
+
+    auto& record = telemetryRecord;
+
+    //A dropout usually comes from the whole chain being late, not from this plugin alone, so watch the
+    //wall clock against the audio asked for too. See Telemetry::referenceSeconds for how.
+    using juce::Time;
+    auto blockSeconds = numSamples / currentSampleRate;
+    auto paused = lastBlockStartTicks == 0
+               || Time::highResolutionTicksToSeconds(blockStartTicks - lastBlockStartTicks) > Telemetry::maxPauseSeconds;
+    lastBlockStartTicks = blockStartTicks;
+
+    if (paused || clockReferenceTicks == 0 || audioSecondsSinceReference >= Telemetry::referenceSeconds) {
+        clockReferenceTicks = blockStartTicks;
+        audioSecondsSinceReference = 0.0;
+    }
+
+    auto drift = Time::highResolutionTicksToSeconds(blockStartTicks - clockReferenceTicks) - audioSecondsSinceReference;
+    record.clockDriftMicros = static_cast<float>(drift * 1.0e6);
+
+    //count it once and start again from here, otherwise every block after a dropout would look late as well
+    if (drift > blockSeconds) {
+        ++record.lateCallbacks;
+        clockReferenceTicks = blockStartTicks;
+        audioSecondsSinceReference = 0.0;
+    }
+
+    audioSecondsSinceReference += blockSeconds;
+
+    record.numSamples = static_cast<uint32_t>(numSamples);
+    record.budgetMicros = static_cast<float>(blockSeconds * 1.0e6);
+
+    for (int channel = 0; channel < Telemetry::maxChannels; ++channel) {
+        record.peak[channel] = peak[channel];
+        record.rms[channel] = rms[channel];
+    }
+
+    if (juce::jmax(peak[0], peak[1]) >= 1.f) {
+        ++record.clippedBlocks;
+    }
+
+    for (int i = 0; i < juce::jmin(telemetryParameters.size(), Telemetry::maxParameters); ++i) {
+        auto* parameter = telemetryParameters.getUnchecked(i);
+        record.parameters[i] = parameter->convertFrom0to1(parameter->getValue());
+    }
+
+    //read the clock last so the snapshot counts towards the block too
+    record.cpuMicros = static_cast<float>(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - blockStartTicks) * 1.0e6);
+
+    if (record.cpuMicros > record.budgetMicros) {
+        ++record.overruns;
+    }
+
+    telemetry.publish(record);
+}
+
+EmphasisFilter::Settings SimpleDistortionAudioProcessor::getEmphasisSettings()
+{
+    auto tilt = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("Tilt"));
+    auto highPass = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("HighPass"));
+    auto lowPass = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("LowPass"));
+    auto midFreq = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("MidFreq"));
+    auto midGain = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("MidGain"));
+
+    EmphasisFilter::Settings settings;
+    settings.tilt = tilt->get();
+    settings.highPass = highPass->get();
+    settings.lowPass = lowPass->get();
+    settings.midFrequency = midFreq->get();
+    settings.midGain = midGain->get();
+    return settings;
+}
+
 //This is where we create the actual layout [STEP 2]
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleDistortionAudioProcessor::createParamLayout() 
 {
@@ -286,6 +513,20 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleDistortionAudioProcess
     layout.add(std::make_unique<AudioParameterFloat>("Range", "Range", blendRange, 0));
     layout.add(std::make_unique<AudioParameterFloat>("Blend", "Blend", blendRange, 0));
     layout.add(std::make_unique<AudioParameterFloat>("Volume", "Volume", volumeRange, 0));
+    layout.add(std::make_unique<AudioParameterChoice>("Engine", "Engine", StringArray{ "Tanh", "Amp Model" }, 0));
+
+    auto tiltRange = NormalisableRange<float>(-12, 12, .1, 1);
+    auto highPassRange = NormalisableRange<float>(EmphasisFilter::highPassOff, 1000, 1, .3);
+    auto lowPassRange = NormalisableRange<float>(1000, EmphasisFilter::lowPassOff, 1, .3);
+    auto midFreqRange = NormalisableRange<float>(200, 5000, 1, .3);
+
+    //pre-emphasis goes into the shaper, de-emphasis undoes the tilt and mid boost after it.
+    //Added after Engine so hosts that address parameters by index keep the older ones where they were.
+    layout.add(std::make_unique<AudioParameterFloat>("Tilt", "Tilt", tiltRange, 0));
+    layout.add(std::make_unique<AudioParameterFloat>("HighPass", "High Pass", highPassRange, EmphasisFilter::highPassOff));
+    layout.add(std::make_unique<AudioParameterFloat>("LowPass", "Low Pass", lowPassRange, EmphasisFilter::lowPassOff));
+    layout.add(std::make_unique<AudioParameterFloat>("MidFreq", "Mid Freq", midFreqRange, 1000));
+    layout.add(std::make_unique<AudioParameterFloat>("MidGain", "Mid Gain", tiltRange, 0));
 
     return layout;
 }
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AmpModelChain.h"
+#include "TelemetryPublisher.h"
 
 //==============================================================================
 /**
@@ -59,6 +61,13 @@ public:
     float getRMSValue(int channel);
     float getOutRMSValue(int channel);
 
+    //Loads an amp capture for the "Amp Model" engine. Call from the message thread, the old model is freed there too.
+    bool loadAmpModel(const juce::File& file, juce::String& error);
+    void clearAmpModel(const juce::String& reason = {});
+
+    //what the editor shows next to the engine box, the model name or why the last load failed
+    juce::String getAmpModelStatus() const;
+
     //This allows you to connect the buttons on your GUI to actual change in the audio [STEP 1]
     using APVTS = juce::AudioProcessorValueTreeState;
     static APVTS::ParameterLayout createParamLayout();
@@ -75,6 +84,29 @@ private:
 
     float rmsLevelLeft, rmsLevelRight;
     float rmsOutLevelLeft, rmsOutLevelRight;
+
+    //the audio thread only ever try-locks this, so a load in progress just means one block of tanh
+    std::unique_ptr<AmpModel> ampModel;
+    juce::SpinLock ampModelLock;
+    juce::String ampModelName, ampModelError;
+    juce::CriticalSection ampModelInfoLock; //the strings above, the host can restore state off the message thread
+    AmpModelChain ampModelChain;
+    int currentBlockSize{ 512 };
+
+    //pre/de-emphasis around the shaper, settings are pushed in at the top of every block
+    EmphasisFilter emphasis;
+    EmphasisFilter::Settings getEmphasisSettings();
+
+    void publishTelemetry(int numSamples, const float* peak, const float* rms, juce::int64 blockStartTicks) noexcept;
+
+    //per block cpu time, levels and parameters for TelemetryMonitor, see TelemetryLayout.h
+    TelemetryPublisher telemetry;
+    Telemetry::Record telemetryRecord{};
+    juce::Array<juce::RangedAudioParameter*> telemetryParameters;
+    double currentSampleRate{ 44100.0 };
+    juce::int64 lastBlockStartTicks{ 0 };
+    juce::int64 clockReferenceTicks{ 0 };  //0 until the next block sets a new reference
+    double audioSecondsSinceReference{ 0.0 };
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleDistortionAudioProcessor)
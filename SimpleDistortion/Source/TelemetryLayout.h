@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    TelemetryLayout.h
+    Created: 19 Oct 2026
+
+    The shared memory layout every plugin instance publishes into and
+    TelemetryMonitor reads. Plain C++ on purpose so both sides agree on it
+    byte for byte, bump version whenever anything in here changes.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Telemetry
+{
+    constexpr uint32_t magic = 0x53445446; //"SDTF"
+    constexpr uint32_t version = 3;
+
+    //each instance gets "/simpledistortion-<pid>-<instance>", which shows up under /dev/shm on linux
+    constexpr const char* segmentPrefix = "simpledistortion-";
+
+    constexpr int ringSize = 256; //a few seconds of blocks at normal buffer sizes
+    constexpr int maxChannels = 2;
+    constexpr int maxParameters = 16;
+    constexpr int maxNameLength = 16;
+
+    /*  Late callbacks are found by comparing the wall clock against the audio the host has asked
+        for since a reference point. Jitter between callbacks cancels out, only a real shortfall builds
+        up, and it counts once the wall clock is more than a block ahead. The reference moves on every
+        referenceSeconds of audio so the gap between the sound card and system clocks can't build up
+        into false alarms, and a callback gap over maxPauseSeconds is the host stopping, not being late.
+    */
+    constexpr double referenceSeconds = 5.0;
+    constexpr double maxPauseSeconds = 1.0;
+
+    //one processBlock call, the counters are running totals since the instance was created
+    struct Record
+    {
+        float cpuMicros;            //time spent inside processBlock
+        float budgetMicros;         //numSamples / sampleRate
+        float clockDriftMicros;     //wall clock minus audio time since the reference point, positive is behind
+        uint32_t overruns;          //blocks where this instance alone took longer than budgetMicros
+        uint32_t lateCallbacks;     //blocks that started with clockDriftMicros over a block, the host fell behind
+        uint32_t clippedBlocks;     //blocks with an output peak at or over 0 dBFS
+        uint32_t numSamples;
+        float peak[maxChannels];    //output levels, linear gain
+        float rms[maxChannels];
+        float parameters[maxParameters]; //real values, not normalised, in the order of parameterNames
+    };
+
+    /*  The audio thread is the only writer. It fills records[writeCount % ringSize] and then
+        bumps writeCount with release ordering, so a reader that loads writeCount with acquire
+        can copy everything below it. Once it has copied, the reader loads writeCount again and
+        throws away any record the writer could have lapped in the meantime.
+    */
+    struct Segment
+    {
+        uint32_t magic;
+        uint32_t version;
+        int32_t pid;
+        int32_t numParameters;
+        char parameterNames[maxParameters][maxNameLength];
+
+        std::atomic<uint64_t> writeCount;
+        Record records[ringSize];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "writeCount has to be lock free to live in shared memory");
+}
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    TelemetryPublisher.cpp
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#include "TelemetryPublisher.h"
+
+#if JUCE_LINUX
+ #include <cerrno>
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <unistd.h>
+#endif
+
+TelemetryPublisher::TelemetryPublisher()
+{
+   #if JUCE_LINUX
+    static std::atomic<int> instanceCounter{ 0 };
+
+    auto pid = static_cast<int>(getpid());
+    auto fd = -1;
+
+    //Never take over a segment that's already there, it might still be mapped by a live instance
+    //(a second copy of the plugin binary has its own counter) or be left over from a dead process with our pid.
+    for (int attempt = 0; attempt < maxCreateAttempts && fd < 0; ++attempt) {
+        segmentName = "/" + juce::String(Telemetry::segmentPrefix) + juce::String(pid) + "-" + juce::String(instanceCounter++);
+        fd = shm_open(segmentName.toRawUTF8(), O_CREAT | O_EXCL | O_RDWR, 0644);
+
+        if (fd < 0 && errno != EEXIST) {
+            break;
+        }
+    }
+
+    if (fd < 0) {
+        return; //no telemetry, the plugin still works
+    }
+
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, sizeof(Telemetry::Segment)) == 0) {
+        memory = mmap(nullptr, sizeof(Telemetry::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (memory == MAP_FAILED) {
+        shm_unlink(segmentName.toRawUTF8());
+        return;
+    }
+
+    //zeroing every page here means the audio thread never takes the first touch page faults
+    std::memset(memory, 0, sizeof(Telemetry::Segment));
+
+    segment = new (memory) Telemetry::Segment();
+    segment->version = Telemetry::version;
+    segment->pid = pid;
+    segment->writeCount.store(0, std::memory_order_relaxed);
+
+    //magic goes in last, the monitor skips anything without it
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->magic = Telemetry::magic;
+   #endif
+}
+
+TelemetryPublisher::~TelemetryPublisher()
+{
+   #if JUCE_LINUX
+    if (segment != nullptr) {
+        segment->~Segment();
+        munmap(segment, sizeof(Telemetry::Segment));
+        shm_unlink(segmentName.toRawUTF8());
+    }
+   #endif
+}
+
+void TelemetryPublisher::setParameterNames(const juce::StringArray& names)
+{
+    if (segment == nullptr) {
+        return;
+    }
+
+    auto numParameters = juce::jmin(names.size(), Telemetry::maxParameters);
+
+    for (int i = 0; i < numParameters; ++i) {
+        names[i].copyToUTF8(segment->parameterNames[i], Telemetry::maxNameLength);
+    }
+
+    segment->numParameters = numParameters;
+}
+
+void TelemetryPublisher::publish(const Telemetry::Record& record) noexcept
+{
+    if (segment == nullptr) {
+        return;
+    }
+
+    segment->records[writeCount % Telemetry::ringSize] = record;
+    segment->writeCount.store(++writeCount, std::memory_order_release);
+}
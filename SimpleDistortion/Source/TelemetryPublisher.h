@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    TelemetryPublisher.h
+    Created: 19 Oct 2026
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TelemetryLayout.h"
+
+//==============================================================================
+/**
+    Publishes one Telemetry::Record per processBlock into a POSIX shared memory ring
+    so TelemetryMonitor can watch every instance on the machine without an editor open.
+
+    The segment is created, touched and mapped in the constructor, so publish() is a copy
+    and an atomic store with no syscalls or page faults. On platforms other than linux it
+    does nothing.
+*/
+class TelemetryPublisher
+{
+public:
+    TelemetryPublisher();
+    ~TelemetryPublisher();
+
+    bool isActive() const noexcept { return segment != nullptr; }
+
+    //call before the first publish, names longer than Telemetry::maxNameLength - 1 get cut short
+    void setParameterNames(const juce::StringArray& names);
+
+    //realtime safe
+    void publish(const Telemetry::Record& record) noexcept;
+
+private:
+    //names already taken on /dev/shm are skipped, give up after this many
+    static constexpr int maxCreateAttempts = 64;
+
+    Telemetry::Segment* segment{ nullptr };
+    juce::String segmentName;
+    uint64_t writeCount{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TelemetryPublisher)
+};
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+
+    Lists every SimpleDistortion instance on this machine with its DSP load,
+    overruns, late callbacks, output levels, clipping and parameters. It only maps the shared
+    memory read only, so it never gets in the way of the audio thread.
+
+        TelemetryMonitor            print once
+        TelemetryMonitor --watch    refresh every second
+        TelemetryMonitor --clean    remove segments left behind by crashed hosts
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../SimpleDistortion/Source/TelemetryLayout.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    struct Summary
+    {
+        int pid = 0;
+        uint64_t blocks = 0;
+        float averageLoad = 0.f, worstLoad = 0.f; //fraction of the block's time budget
+        float maxPeak[Telemetry::maxChannels] = {}; //over every record copied, not just the last block
+        Telemetry::Record latest{};
+        juce::StringArray parameterNames;
+    };
+
+    juce::String toDecibels(float gain)
+    {
+        return juce::String(juce::Decibels::gainToDecibels(gain, -100.f), 1);
+    }
+
+    bool isAlive(int pid)
+    {
+        return kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+    //copies the ring out of shared memory and keeps whatever the writer didn't lap while we were reading
+    bool readSegment(const Telemetry::Segment& segment, Summary& summary)
+    {
+        if (segment.magic != Telemetry::magic || segment.version != Telemetry::version) {
+            return false;
+        }
+
+        summary.pid = segment.pid;
+
+        for (int i = 0; i < juce::jlimit(0, Telemetry::maxParameters, (int)segment.numParameters); ++i) {
+            auto* name = segment.parameterNames[i];
+            summary.parameterNames.add(juce::String::fromUTF8(name, (int)strnlen(name, Telemetry::maxNameLength)));
+        }
+
+        auto end = segment.writeCount.load(std::memory_order_acquire);
+        auto begin = end > (uint64_t)Telemetry::ringSize ? end - Telemetry::ringSize : 0;
+
+        std::vector<Telemetry::Record> records;
+        for (auto i = begin; i < end; ++i) {
+            records.push_back(segment.records[i % Telemetry::ringSize]);
+        }
+
+        //the writer may be filling the slot for index writeCount, which is the one that used to hold writeCount - ringSize
+        std::atomic_thread_fence(std::memory_order_acquire);
+        auto after = segment.writeCount.load(std::memory_order_relaxed);
+        auto firstValid = after >= (uint64_t)Telemetry::ringSize ? after - Telemetry::ringSize + 1 : 0;
+
+        if (firstValid > begin) {
+            records.erase(records.begin(), records.begin() + (ptrdiff_t)juce::jmin((uint64_t)records.size(), firstValid - begin));
+        }
+
+        summary.blocks = end;
+        if (records.empty()) {
+            return true;
+        }
+
+        for (auto& record : records) {
+            auto load = record.budgetMicros > 0.f ? record.cpuMicros / record.budgetMicros : 0.f;
+            summary.averageLoad += load;
+            summary.worstLoad = juce::jmax(summary.worstLoad, load);
+
+            for (int channel = 0; channel < Telemetry::maxChannels; ++channel) {
+                summary.maxPeak[channel] = juce::jmax(summary.maxPeak[channel], record.peak[channel]);
+            }
+        }
+
+        summary.averageLoad /= (float)records.size();
+        summary.latest = records.back();
+        return true;
+    }
+
+    bool mapSegment(const juce::String& name, Summary& summary)
+    {
+        auto fd = shm_open(name.toRawUTF8(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Telemetry::Segment)) {
+            close(fd);
+            return false;
+        }
+
+        auto* memory = mmap(nullptr, sizeof(Telemetry::Segment), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (memory == MAP_FAILED) {
+            return false;
+        }
+
+        auto ok = readSegment(*static_cast<const Telemetry::Segment*>(memory), summary);
+        munmap(memory, sizeof(Telemetry::Segment));
+        return ok;
+    }
+
+    //"simpledistortion-<pid>-<n>", read from the name so segments we can't map still get cleaned up
+    int pidFromName(const juce::String& fileName)
+    {
+        return fileName.fromFirstOccurrenceOf(Telemetry::segmentPrefix, false, false).upToFirstOccurrenceOf("-", false, false).getIntValue();
+    }
+
+    void printInstances(bool clean)
+    {
+        auto segments = juce::File("/dev/shm").findChildFiles(juce::File::findFiles, false, juce::String(Telemetry::segmentPrefix) + "*");
+        segments.sort();
+
+        std::cout << juce::String("instance").paddedRight(' ', 32) << "blocks    avg%   max%   overrun late    clips   peak L/R dB    rms L/R dB" << std::endl;
+
+        for (auto& file : segments) {
+            auto name = "/" + file.getFileName();
+            auto pid = pidFromName(file.getFileName());
+
+            //checked before mapping, a host that crashed early or an older build may have left a header we don't understand
+            if (pid > 0 && !isAlive(pid)) {
+                if (clean) {
+                    shm_unlink(name.toRawUTF8());
+                    std::cout << file.getFileName() << " removed, pid " << pid << " is gone" << std::endl;
+                }
+                else {
+                    std::cout << file.getFileName().paddedRight(' ', 32) << "stale, pid " << pid << " is gone" << std::endl;
+                }
+                continue;
+            }
+
+            Summary summary;
+
+            if (!mapSegment(name, summary)) {
+                std::cout << file.getFileName().paddedRight(' ', 32) << "unreadable or from another version" << std::endl;
+                continue;
+            }
+
+            auto& latest = summary.latest;
+            auto clipping = juce::jmax(summary.maxPeak[0], summary.maxPeak[1]) >= 1.f;
+
+            std::cout << file.getFileName().paddedRight(' ', 32)
+                      << juce::String((juce::int64)summary.blocks).paddedRight(' ', 10)
+                      << juce::String(summary.averageLoad * 100.f, 1).paddedRight(' ', 7)
+                      << juce::String(summary.worstLoad * 100.f, 1).paddedRight(' ', 7)
+                      << juce::String((int)latest.overruns).paddedRight(' ', 8)
+                      << juce::String((int)latest.lateCallbacks).paddedRight(' ', 8)
+                      << juce::String((int)latest.clippedBlocks).paddedRight(' ', 8)
+                      << (toDecibels(summary.maxPeak[0]) + "/" + toDecibels(summary.maxPeak[1])).paddedRight(' ', 14)
+                      << toDecibels(latest.rms[0]) << "/" << toDecibels(latest.rms[1])
+                      << (clipping ? "  CLIP" : "") << std::endl;
+
+            juce::StringArray parameters;
+            for (int i = 0; i < summary.parameterNames.size(); ++i) {
+                parameters.add(summary.parameterNames[i] + "=" + juce::String(latest.parameters[i], 2));
+            }
+
+            if (!parameters.isEmpty()) {
+                std::cout << "    " << parameters.joinIntoString(" ") << std::endl;
+            }
+        }
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i) {
+        args.add(argv[i]);
+    }
+
+    auto watch = args.contains("--watch") || args.contains("-w");
+    auto clean = args.contains("--clean");
+
+    do {
+        if (watch) {
+            std::cout << "\x1b[2J\x1b[H"; //clear the terminal between refreshes
+        }
+
+        printInstances(clean);
+
+        if (watch) {
+            juce::Thread::sleep(1000);
+        }
+    } while (watch);
+
+    return 0;
+}